@@ -0,0 +1,89 @@
+#include "harness.hpp"
+#include "../binsearch/binsearch.hpp"
+
+// Naive solution from binsearch.md
+template <typename T>
+static int64_t linearSearch(const std::vector<T> &array, const T& searchingValue) {
+    for(uint64_t i = 0; i < array.size(); i++) {
+        if(array[i] == searchingValue)
+            return int64_t(i);
+    }
+
+    return -1;
+}
+
+void benchBinsearch(const benchConfig_t &config, benchReporter_t &reporter) {
+    for(const std::string &distribution : config.distributions) {
+        for(uint64_t size : config.sizes) {
+            if(size == 0)
+                continue;
+
+            // Search works only on sorted arrays, distribution controls duplicates only
+            std::vector<uint64_t> values = generateValues<uint64_t>(distribution, size, config.seed);
+            std::sort(values.begin(), values.end());
+
+            // Queries hit existing elements, as in binsearch.md
+            std::mt19937_64 rng(config.seed + 1);
+            std::vector<uint64_t> queries(config.queries);
+
+            for(uint64_t &query : queries)
+                query = values[rng() % size];
+
+            const uint64_t* begin = values.data();
+            const uint64_t* end = begin + size;
+            auto nothing = []() {};
+
+            if(double(size) * double(queries.size()) <= config.naiveLimit) {
+                reporter.add(measure(config, nothing, [&]() {
+                    int64_t sum = 0;
+
+                    for(uint64_t query : queries)
+                        sum += linearSearch(values, query);
+
+                    keepValue(sum);
+                }, queries.size()), "binsearch", "linearSearch", distribution, size);
+            }
+
+            const searchPriority priorities[] = {ANY_ENTRANCE, LEFT_ENTRANCE, RIGHT_ENTRANCE};
+            const char* names[] = {"search(ANY_ENTRANCE)", "search(LEFT_ENTRANCE)", "search(RIGHT_ENTRANCE)"};
+
+            for(uint32_t p = 0; p < 3; p++) {
+                reporter.add(measure(config, nothing, [&]() {
+                    int64_t sum = 0;
+
+                    for(uint64_t query : queries)
+                        sum += search(begin, end, query, priorities[p]);
+
+                    keepValue(sum);
+                }, queries.size()), "binsearch", names[p], distribution, size);
+            }
+
+            reporter.add(measure(config, nothing, [&]() {
+                int64_t sum = 0;
+
+                for(uint64_t query : queries)
+                    sum += std::lower_bound(begin, end, query) - begin;
+
+                keepValue(sum);
+            }, queries.size()), "binsearch", "std::lower_bound", distribution, size);
+
+            reporter.add(measure(config, nothing, [&]() {
+                int64_t sum = 0;
+
+                for(uint64_t query : queries)
+                    sum += std::upper_bound(begin, end, query) - begin;
+
+                keepValue(sum);
+            }, queries.size()), "binsearch", "std::upper_bound", distribution, size);
+
+            reporter.add(measure(config, nothing, [&]() {
+                bool found = false;
+
+                for(uint64_t query : queries)
+                    found ^= std::binary_search(begin, end, query);
+
+                keepValue(found);
+            }, queries.size()), "binsearch", "std::binary_search", distribution, size);
+        }
+    }
+}
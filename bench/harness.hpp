@@ -0,0 +1,209 @@
+#ifndef BENCH_HARNESS_HPP
+#define BENCH_HARNESS_HPP
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+
+struct benchConfig_t {
+    // Array ( or string ) sizes to sweep over
+    std::vector<uint64_t> sizes;
+    // Second sweep parameter: window width for sliding window and segment tree
+    std::vector<uint64_t> widths;
+    // Data distributions, see `generateValues`
+    std::vector<std::string> distributions;
+    // Algorithms to run, empty means all
+    std::vector<std::string> algorithms;
+    uint32_t warmup;
+    uint32_t repetitions;
+    // Count of queries per repetition for algorithms with tiny single call time
+    uint64_t queries;
+    uint64_t seed;
+    // Naive O(n^2)-like variants are skipped when their work estimate exceeds this limit
+    double naiveLimit;
+    bool json;
+};
+
+struct benchResult_t {
+    std::string algorithm;
+    std::string variant;
+    std::string distribution;
+    uint64_t size;
+    uint64_t param;
+    uint32_t repetitions;
+    // Seconds per operation
+    double median;
+    double min;
+    double max;
+    double mean;
+};
+
+/**
+ * Prevents compiler from throwing away computations which results are unused.
+ */
+template <typename T>
+inline void keepValue(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * Runs `setup()` and then measures `run()` `warmup + repetitions` times. Warmup runs are
+ * not recorded. `setup` is not measured, so it can restore data changed by in-place algorithms.
+ * @param operations - count of operations `run` performs, all times are divided by it.
+ */
+template <typename Setup, typename F>
+benchResult_t measure(const benchConfig_t &config, const Setup &setup, const F &run,
+                      uint64_t operations = 1) {
+    std::vector<double> times;
+    times.reserve(config.repetitions);
+
+    for(uint32_t i = 0; i < config.warmup + config.repetitions; i++) {
+        setup();
+
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+
+        if(i >= config.warmup)
+            times.push_back(std::chrono::duration<double>(end - start).count() / double(operations));
+    }
+
+    std::sort(times.begin(), times.end());
+
+    benchResult_t result = {};
+
+    result.repetitions = config.repetitions;
+
+    if(times.empty())
+        return result;
+
+    const uint64_t middle = times.size() / 2;
+
+    result.median = times.size() % 2 ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+    result.min = times.front();
+    result.max = times.back();
+
+    for(double time : times)
+        result.mean += time;
+
+    result.mean /= double(times.size());
+
+    return result;
+}
+
+/**
+ * Generates `size` values with provided distribution:
+ * - uniform - uniformly random values
+ * - sorted - uniformly random values sorted ascending
+ * - reversed - uniformly random values sorted descending
+ * - fewunique - only 16 distinct values ( lots of duplicates )
+ */
+template <typename T>
+std::vector<T> generateValues(const std::string &distribution, uint64_t size, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> values(size);
+
+    for(T& value : values) {
+        value = T(rng());
+
+        if(distribution == "fewunique")
+            value = T(value % 16);
+    }
+
+    if(distribution == "sorted")
+        std::sort(values.begin(), values.end());
+    else if(distribution == "reversed")
+        std::sort(values.rbegin(), values.rend());
+
+    return values;
+}
+
+/**
+ * Generates a string over small alphabet. For `fewunique` distribution the string consists of
+ * repeated prefixes, which is the worst case for naive z-function.
+ */
+inline std::string generateString(const std::string &distribution, uint64_t size, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::string str(size, 'a');
+
+    if(distribution == "fewunique") {
+        const uint64_t period = 1 + rng() % 8;
+
+        for(uint64_t i = 0; i < size; i++)
+            str[i] = char('a' + (i % period == period - 1 ? 1 : 0));
+
+        return str;
+    }
+
+    for(char& c : str)
+        c = char('a' + rng() % 4);
+
+    if(distribution == "sorted")
+        std::sort(str.begin(), str.end());
+    else if(distribution == "reversed")
+        std::sort(str.rbegin(), str.rend());
+
+    return str;
+}
+
+class benchReporter_t {
+   private:
+    std::vector<benchResult_t> results;
+
+   public:
+    void add(benchResult_t result, const std::string &algorithm, const std::string &variant,
+             const std::string &distribution, uint64_t size, uint64_t param = 0) {
+        result.algorithm = algorithm;
+        result.variant = variant;
+        result.distribution = distribution;
+        result.size = size;
+        result.param = param;
+
+        // Print progress, so long runs don't look stuck
+        fprintf(stderr, "%s/%s %s n=%llu p=%llu: %.9f\n", algorithm.c_str(), variant.c_str(),
+                distribution.c_str(), (unsigned long long)size, (unsigned long long)param,
+                result.median);
+
+        this->results.push_back(result);
+    }
+
+    void printCsv(FILE* out) const {
+        fprintf(out, "algorithm,variant,distribution,size,param,repetitions,median,min,max,mean\n");
+
+        for(const benchResult_t &r : this->results) {
+            fprintf(out, "%s,%s,%s,%llu,%llu,%u,%.12e,%.12e,%.12e,%.12e\n", r.algorithm.c_str(),
+                    r.variant.c_str(), r.distribution.c_str(), (unsigned long long)r.size,
+                    (unsigned long long)r.param, r.repetitions, r.median, r.min, r.max, r.mean);
+        }
+    }
+
+    void printJson(FILE* out) const {
+        fprintf(out, "[\n");
+
+        for(uint64_t i = 0; i < this->results.size(); i++) {
+            const benchResult_t &r = this->results[i];
+
+            fprintf(out,
+                    "  {\"algorithm\": \"%s\", \"variant\": \"%s\", \"distribution\": \"%s\", "
+                    "\"size\": %llu, \"param\": %llu, \"repetitions\": %u, \"median\": %.12e, "
+                    "\"min\": %.12e, \"max\": %.12e, \"mean\": %.12e}%s\n",
+                    r.algorithm.c_str(), r.variant.c_str(), r.distribution.c_str(),
+                    (unsigned long long)r.size, (unsigned long long)r.param, r.repetitions,
+                    r.median, r.min, r.max, r.mean, i + 1 == this->results.size() ? "" : ",");
+        }
+
+        fprintf(out, "]\n");
+    }
+};
+
+// One harness per algorithm, each one is defined in its own translation unit
+void benchRadix(const benchConfig_t &config, benchReporter_t &reporter);
+void benchBinsearch(const benchConfig_t &config, benchReporter_t &reporter);
+void benchSegtree(const benchConfig_t &config, benchReporter_t &reporter);
+void benchZfunc(const benchConfig_t &config, benchReporter_t &reporter);
+void benchSlidingWindow(const benchConfig_t &config, benchReporter_t &reporter);
+
+#endif
@@ -0,0 +1,129 @@
+#include <string.h>
+#include <stdlib.h>
+#include "harness.hpp"
+
+static std::vector<std::string> splitList(const char* list) {
+    std::vector<std::string> items;
+    std::string current;
+
+    for(const char* c = list; ; c++) {
+        if(*c == ',' || *c == '\0') {
+            if(!current.empty())
+                items.push_back(current);
+
+            current.clear();
+
+            if(*c == '\0')
+                break;
+        } else {
+            current += *c;
+        }
+    }
+
+    return items;
+}
+
+static std::vector<uint64_t> splitNumbers(const char* list) {
+    std::vector<uint64_t> numbers;
+
+    for(const std::string &item : splitList(list))
+        numbers.push_back(uint64_t(strtod(item.c_str(), nullptr)));
+
+    return numbers;
+}
+
+static void printUsage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --algo=LIST       radix,binsearch,segtree,zfunc,sliding ( default: all )\n"
+            "  --sizes=LIST      array sizes, e.g. 10,1e3,1e6\n"
+            "  --widths=LIST     window widths for sliding window and segment tree\n"
+            "  --dist=LIST       uniform,sorted,reversed,fewunique\n"
+            "  --warmup=N        unmeasured runs before measuring ( default: 1 )\n"
+            "  --reps=N          measured runs ( default: 5 )\n"
+            "  --queries=N       queries per run for search and segment tree ( default: 100000 )\n"
+            "  --naive-limit=X   skip naive variants doing more than X steps ( default: 1e9 )\n"
+            "  --seed=N          random seed\n"
+            "  --format=csv|json output format for stdout ( default: csv )\n",
+            name);
+}
+
+static bool isSelected(const benchConfig_t &config, const char* algorithm) {
+    return config.algorithms.empty() ||
+           std::find(config.algorithms.begin(), config.algorithms.end(), algorithm) != config.algorithms.end();
+}
+
+int main(int argc, char** argv) {
+    benchConfig_t config;
+
+    config.sizes = {10, 100, 1000, 10000, 100000, 1000000};
+    config.widths = {1, 10, 100, 1000, 10000};
+    config.distributions = {"uniform"};
+    config.warmup = 1;
+    config.repetitions = 5;
+    config.queries = 100000;
+    config.seed = 42;
+    config.naiveLimit = 1e9;
+    config.json = false;
+
+    for(int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = strchr(arg, '=');
+
+        if(value == nullptr) {
+            printUsage(argv[0]);
+            return strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+
+        value++;
+
+        if(strncmp(arg, "--algo=", 7) == 0) {
+            config.algorithms = splitList(value);
+        } else if(strncmp(arg, "--sizes=", 8) == 0) {
+            config.sizes = splitNumbers(value);
+        } else if(strncmp(arg, "--widths=", 9) == 0) {
+            config.widths = splitNumbers(value);
+        } else if(strncmp(arg, "--dist=", 7) == 0) {
+            config.distributions = splitList(value);
+        } else if(strncmp(arg, "--warmup=", 9) == 0) {
+            config.warmup = uint32_t(atoi(value));
+        } else if(strncmp(arg, "--reps=", 7) == 0) {
+            config.repetitions = uint32_t(std::max(1, atoi(value)));
+        } else if(strncmp(arg, "--queries=", 10) == 0) {
+            config.queries = std::max<uint64_t>(1, uint64_t(strtod(value, nullptr)));
+        } else if(strncmp(arg, "--naive-limit=", 14) == 0) {
+            config.naiveLimit = strtod(value, nullptr);
+        } else if(strncmp(arg, "--seed=", 7) == 0) {
+            config.seed = strtoull(value, nullptr, 10);
+        } else if(strncmp(arg, "--format=", 9) == 0) {
+            config.json = strcmp(value, "json") == 0;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    benchReporter_t reporter;
+
+    if(isSelected(config, "radix"))
+        benchRadix(config, reporter);
+
+    if(isSelected(config, "binsearch"))
+        benchBinsearch(config, reporter);
+
+    if(isSelected(config, "segtree"))
+        benchSegtree(config, reporter);
+
+    if(isSelected(config, "zfunc"))
+        benchZfunc(config, reporter);
+
+    if(isSelected(config, "sliding"))
+        benchSlidingWindow(config, reporter);
+
+    if(config.json)
+        reporter.printJson(stdout);
+    else
+        reporter.printCsv(stdout);
+
+    return 0;
+}
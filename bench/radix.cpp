@@ -0,0 +1,60 @@
+#include "harness.hpp"
+#include "../sort/radix/radix.hpp"
+
+static void u32toKey(uint32_t& element, void** key, uint32_t* keylen) {
+    (*key) = (void*)&element;
+    (*keylen) = sizeof(uint32_t);
+}
+
+void benchRadix(const benchConfig_t &config, benchReporter_t &reporter) {
+    for(const std::string &distribution : config.distributions) {
+        for(uint64_t size : config.sizes) {
+            if(size == 0)
+                continue;
+
+            const std::vector<uint32_t> source = generateValues<uint32_t>(distribution, size, config.seed);
+
+            std::vector<uint32_t> values(size);
+            std::vector<uint32_t> out(size);
+
+            auto restore = [&]() { values = source; };
+
+            reporter.add(measure(config, restore, [&]() {
+                radixSort(values.data(), values.data() + size, out.data(), u32toKey);
+                keepValue(out[0]);
+            }), "radix", "radixSort", distribution, size);
+
+            reporter.add(measure(config, restore, [&]() {
+                radixSort<2>(values.data(), values.data() + size, out.data(), u32toKey);
+                keepValue(out[0]);
+            }), "radix", "radixSort<2>", distribution, size);
+
+            reporter.add(measure(config, restore, [&]() {
+                radixSortInPlace(values.data(), values.data() + size, u32toKey);
+                keepValue(values[0]);
+            }), "radix", "radixSortInPlace", distribution, size);
+
+            std::vector<uint32_t> permutation(size);
+
+            reporter.add(measure(config, restore, [&]() {
+                radixArgsort(values.data(), values.data() + size, permutation.data(), u32toKey);
+                keepValue(permutation[0]);
+            }), "radix", "radixArgsort", distribution, size);
+
+            reporter.add(measure(config, restore, [&]() {
+                applyPermutation(permutation.data(), size, values.data(), out.data());
+                keepValue(out[0]);
+            }), "radix", "applyPermutation", distribution, size);
+
+            reporter.add(measure(config, restore, [&]() {
+                std::sort(values.begin(), values.end());
+                keepValue(values[0]);
+            }), "radix", "std::sort", distribution, size);
+
+            reporter.add(measure(config, restore, [&]() {
+                std::stable_sort(values.begin(), values.end());
+                keepValue(values[0]);
+            }), "radix", "std::stable_sort", distribution, size);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include <numeric>
+#include "harness.hpp"
+#include "../segtree/segtree.hpp"
+
+static void summator(uint64_t& result, const uint64_t& left, const uint64_t& right) {
+    result = left + right;
+}
+
+static void sumQueryUpdate(uint64_t& result, const uint64_t& segment) {
+    result += segment;
+}
+
+// Naive solution from segtree.md
+template <typename T>
+static T calcSum(const std::vector<T> &values, uint64_t l, uint64_t r) {
+    T sum = 0;
+
+    for(uint64_t i = l; i < r; i++) {
+        sum += values[i];
+    }
+
+    return sum;
+}
+
+void benchSegtree(const benchConfig_t &config, benchReporter_t &reporter) {
+    for(const std::string &distribution : config.distributions) {
+        for(uint64_t size : config.sizes) {
+            if(size == 0)
+                continue;
+
+            std::vector<uint64_t> values = generateValues<uint64_t>(distribution, size, config.seed);
+
+            SegmentTree<uint64_t, summator> tree((uint32_t)size);
+
+            auto nothing = []() {};
+
+            reporter.add(measure(config, nothing, [&]() {
+                tree.fillup(values.data());
+            }), "segtree", "fillup", distribution, size);
+
+            std::mt19937_64 rng(config.seed + 1);
+
+            for(uint64_t width : config.widths) {
+                if(width == 0 || width > size)
+                    continue;
+
+                std::vector<uint64_t> lefts(config.queries);
+
+                for(uint64_t &left : lefts)
+                    left = rng() % (size - width + 1);
+
+                if(double(width) * double(lefts.size()) <= config.naiveLimit) {
+                    reporter.add(measure(config, nothing, [&]() {
+                        uint64_t sum = 0;
+
+                        for(uint64_t left : lefts)
+                            sum += calcSum(values, left, left + width);
+
+                        keepValue(sum);
+                    }, lefts.size()), "segtree", "calcSum", distribution, size, width);
+
+                    reporter.add(measure(config, nothing, [&]() {
+                        uint64_t sum = 0;
+
+                        for(uint64_t left : lefts)
+                            sum += std::accumulate(values.begin() + left, values.begin() + left + width, uint64_t(0));
+
+                        keepValue(sum);
+                    }, lefts.size()), "segtree", "std::accumulate", distribution, size, width);
+                }
+
+                reporter.add(measure(config, nothing, [&]() {
+                    uint64_t sum = 0;
+
+                    for(uint64_t left : lefts)
+                        sum += tree.operate(int32_t(left), int32_t(left + width), uint64_t(0), sumQueryUpdate);
+
+                    keepValue(sum);
+                }, lefts.size()), "segtree", "operate", distribution, size, width);
+            }
+
+            std::vector<uint64_t> indexes(config.queries);
+
+            for(uint64_t &index : indexes)
+                index = rng() % size;
+
+            reporter.add(measure(config, nothing, [&]() {
+                for(uint64_t index : indexes)
+                    tree.setValue(uint32_t(index), index);
+            }, indexes.size()), "segtree", "setValue", distribution, size);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include "harness.hpp"
+#include "../sliding window/minimum.hpp"
+
+// Naive solution from sliding-window.md
+template <typename T>
+static std::vector<T> minimumForSlidingWindowCorrect(const std::vector<T> &array, uint64_t slidingWindowWidth) {
+    std::vector<T> minimums(array.size() - slidingWindowWidth + 1);
+
+    for(uint64_t i = 0; i < array.size() - slidingWindowWidth + 1; i++) {
+        T min = array[i];
+
+        for(uint64_t j = i; j < i + slidingWindowWidth; j++) {
+            if(array[j] < min)
+                min = array[j];
+        }
+
+        minimums[i] = min;
+    }
+
+    return minimums;
+}
+
+void benchSlidingWindow(const benchConfig_t &config, benchReporter_t &reporter) {
+    for(const std::string &distribution : config.distributions) {
+        for(uint64_t size : config.sizes) {
+            const std::vector<int64_t> values = generateValues<int64_t>(distribution, size, config.seed);
+
+            std::vector<int64_t> out(size);
+            auto nothing = []() {};
+
+            for(uint64_t width : config.widths) {
+                if(width == 0 || width > size)
+                    continue;
+
+                if(double(size) * double(width) <= config.naiveLimit) {
+                    reporter.add(measure(config, nothing, [&]() {
+                        std::vector<int64_t> minimums = minimumForSlidingWindowCorrect(values, width);
+                        keepValue(minimums.data());
+                    }), "sliding", "naive", distribution, size, width);
+
+                    reporter.add(measure(config, nothing, [&]() {
+                        for(uint64_t i = 0; i + width <= size; i++)
+                            out[i] = *std::min_element(values.begin() + i, values.begin() + i + width);
+
+                        keepValue(out[0]);
+                    }), "sliding", "std::min_element", distribution, size, width);
+                }
+
+                reporter.add(measure(config, nothing, [&]() {
+                    std::vector<int64_t> minimums = minimumForSlidingWindow(values, uint32_t(width));
+                    keepValue(minimums.data());
+                }), "sliding", "minimumForSlidingWindow", distribution, size, width);
+
+                reporter.add(measure(config, nothing, [&]() {
+                    minimumForSlidingWindow(values.begin(), values.end(), width, out.begin());
+                    keepValue(out[0]);
+                }), "sliding", "minimumForSlidingWindow(out)", distribution, size, width);
+            }
+
+            // All widths at once against one pass per width
+            std::vector<uint32_t> widths;
+
+            for(uint64_t width : config.widths) {
+                if(width != 0 && width <= size)
+                    widths.push_back(uint32_t(width));
+            }
+
+            if(widths.empty())
+                continue;
+
+            reporter.add(measure(config, nothing, [&]() {
+                for(uint32_t width : widths) {
+                    minimumForSlidingWindow(values.begin(), values.end(), width, out.begin());
+                    keepValue(out[0]);
+                }
+            }), "sliding", "minimumForSlidingWindow(all widths)", distribution, size, widths.size());
+
+            reporter.add(measure(config, nothing, [&]() {
+                std::vector<std::vector<int64_t>> minimums = minimumForSlidingWindows(values, widths);
+                keepValue(minimums.data());
+            }), "sliding", "minimumForSlidingWindows", distribution, size, widths.size());
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#include "harness.hpp"
+#include "../strings/zfunc/zfunc.hpp"
+
+// Naive solution from zfunc.md
+static std::vector<uint64_t> zfuncNaive(const std::string &str) {
+    uint64_t size = str.size();
+
+    std::vector<uint64_t> zvalues(size, 0);
+
+    for(uint64_t i = 1; i < size; i++) {
+        uint64_t currentPrefixLen = 0;
+
+        while(i + currentPrefixLen < size && str[i + currentPrefixLen] == str[currentPrefixLen]) {
+            currentPrefixLen++;
+        }
+
+        zvalues[i] = currentPrefixLen;
+    }
+
+    return zvalues;
+}
+
+// The same naive solution, but prefixes are compared with std::mismatch
+static std::vector<uint64_t> zfuncMismatch(const std::string &str) {
+    uint64_t size = str.size();
+
+    std::vector<uint64_t> zvalues(size, 0);
+
+    for(uint64_t i = 1; i < size; i++) {
+        zvalues[i] = uint64_t(std::mismatch(str.begin() + i, str.end(), str.begin()).first - str.begin()) - i;
+    }
+
+    return zvalues;
+}
+
+void benchZfunc(const benchConfig_t &config, benchReporter_t &reporter) {
+    for(const std::string &distribution : config.distributions) {
+        for(uint64_t size : config.sizes) {
+            const std::string str = generateString(distribution, size, config.seed);
+
+            auto nothing = []() {};
+
+            // Naive solutions are quadratic in the worst case
+            if(double(size) * double(size) <= config.naiveLimit) {
+                reporter.add(measure(config, nothing, [&]() {
+                    std::vector<uint64_t> zvalues = zfuncNaive(str);
+                    keepValue(zvalues.data());
+                }), "zfunc", "zfuncNaive", distribution, size);
+
+                reporter.add(measure(config, nothing, [&]() {
+                    std::vector<uint64_t> zvalues = zfuncMismatch(str);
+                    keepValue(zvalues.data());
+                }), "zfunc", "std::mismatch", distribution, size);
+            }
+
+            reporter.add(measure(config, nothing, [&]() {
+                std::vector<uint64_t> zvalues = zfunc(str);
+                keepValue(zvalues.data());
+            }), "zfunc", "zfunc", distribution, size);
+        }
+    }
+}
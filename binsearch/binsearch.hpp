@@ -1,8 +1,10 @@
 #ifndef BINSEARCH_HPP
 #define BINSEARCH_HPP
 #include <functional>
+#include <array>
 #include <stdint.h>
 #include "../constants/search_priority.hpp"
+#include "../stats/stats.hpp"
 
 template <typename T>
 struct searchingResult_t {
@@ -22,6 +24,8 @@ struct searchingResult_t {
 */
 template <typename T, typename U>
 int64_t search(const T* begin, const T* end, const U& value, searchPriority priority = searchPriority::ANY_ENTRANCE) {
+    ALGOBOX_STATS_CALL(STATS_BINSEARCH);
+
     const T* array = begin;
 
     // range is represented as [left; right) ( including left and excluding right )
@@ -31,6 +35,8 @@ int64_t search(const T* begin, const T* end, const U& value, searchPriority prio
     while (left < right) {
         int64_t currentIndex = (left + right) / 2;
 
+        ALGOBOX_STATS_ADD(STATS_BINSEARCH_PROBES, 1);
+
         // maybe theese if-branches are not pretty, but I've tried to make this
         // function work when only operator< and operator== are defined.
         if (array[currentIndex] < value) {
@@ -59,6 +65,9 @@ int64_t search(const T* begin, const T* end, const U& value, searchPriority prio
                     while(left + 1 < right) {
                         currentIndex = (left + right) / 2;
 
+                        ALGOBOX_STATS_ADD(STATS_BINSEARCH_NARROWING_STEPS, 1);
+                        ALGOBOX_STATS_ADD(STATS_BINSEARCH_PROBES, 1);
+
                         if(array[currentIndex] == value) {
                             right = currentIndex;
                         } else {
@@ -79,16 +88,16 @@ int64_t search(const T* begin, const T* end, const U& value, searchPriority prio
                     // Nowhere in the code we could include equal element as right
                     // boundary, so don't exclude anything.
 
-                    bool found = array[right] == value;
-
                     while(left + 1 < right) {
                         currentIndex = (left + right) / 2;
 
+                        ALGOBOX_STATS_ADD(STATS_BINSEARCH_NARROWING_STEPS, 1);
+                        ALGOBOX_STATS_ADD(STATS_BINSEARCH_PROBES, 1);
+
                         if(array[currentIndex] == value) {
                             left = currentIndex;
                         } else {
                             right = currentIndex;
-                            found = array[right] == value;
                         }
                     }
 
@@ -124,6 +133,8 @@ int64_t search(const T* begin, const T* end, const U& value, searchPriority prio
 */
 template <typename T, typename U>
 searchingResult_t<T> paramSearch(const T& begin, const T& end, std::function<U(T x)> func, const U& value, searchPriority priority = searchPriority::ANY_ENTRANCE) {
+    ALGOBOX_STATS_CALL(STATS_BINSEARCH);
+
     // range is represented as [left; right) ( including left and excluding right )
     T left = begin;
     T right = end;
@@ -131,6 +142,8 @@ searchingResult_t<T> paramSearch(const T& begin, const T& end, std::function<U(T
     while (left < right) {
         T currentParam = (left + right) / 2;
 
+        ALGOBOX_STATS_ADD(STATS_BINSEARCH_PROBES, 1);
+
         // Even with -O3 saves up operations
         // Turns out, compiler won't optimize and save result of `func(currentParam)` into
         // temp variable as `func` may change global state and thus provide different result
@@ -164,6 +177,9 @@ searchingResult_t<T> paramSearch(const T& begin, const T& end, std::function<U(T
                     while(left + 1 < right) {
                         currentParam = (left + right) / 2;
 
+                        ALGOBOX_STATS_ADD(STATS_BINSEARCH_NARROWING_STEPS, 1);
+                        ALGOBOX_STATS_ADD(STATS_BINSEARCH_PROBES, 1);
+
                         if(func(currentParam) == value) {
                             right = currentParam;
                         } else {
@@ -187,6 +203,9 @@ searchingResult_t<T> paramSearch(const T& begin, const T& end, std::function<U(T
                     while(left + 1 < right) {
                         currentParam = (left + right) / 2;
 
+                        ALGOBOX_STATS_ADD(STATS_BINSEARCH_NARROWING_STEPS, 1);
+                        ALGOBOX_STATS_ADD(STATS_BINSEARCH_PROBES, 1);
+
                         if(func(currentParam) == value) {
                             left = currentParam;
                         } else {
@@ -211,4 +230,127 @@ searchingResult_t<T> paramSearch(const T& begin, const T& end, std::function<U(T
     return {false, (left + right) / 2};
 }
 
-#endif
\ No newline at end of file
+// Algobox's private namespace
+namespace algobox_p {
+
+template <typename T>
+constexpr void constexprSwap(T& a, T& b) {
+    T temp = a;
+    a = b;
+    b = temp;
+}
+
+template <typename T, size_t SIZE>
+constexpr void siftDown(std::array<T, SIZE>& values, size_t root, size_t size) {
+    while (root * 2 + 1 < size) {
+        size_t child = root * 2 + 1;
+
+        if (child + 1 < size && values[child] < values[child + 1])
+            child++;
+
+        if (!(values[root] < values[child]))
+            return;
+
+        constexprSwap(values[root], values[child]);
+        root = child;
+    }
+}
+
+/**
+ * Heap sort, as std::sort can't be evaluated at compile time before C++20.
+ * Has complexity of O(nlogn), so it won't exceed compiler's constexpr limits on big tables.
+ */
+template <typename T, size_t SIZE>
+constexpr void constexprSort(std::array<T, SIZE>& values) {
+    for (size_t i = SIZE / 2; i > 0; i--)
+        siftDown(values, i - 1, SIZE);
+
+    for (size_t i = SIZE; i > 1; i--) {
+        constexprSwap(values[0], values[i - 1]);
+        siftDown(values, 0, i - 1);
+    }
+}
+
+};
+
+/**
+ * Sorted array of fixed size, which can be built and searched at compile time. With
+ * `constexpr` index the table is placed into read-only data and requires no work at
+ * startup, while searches with constant arguments are folded by compiler.
+ * Values are sorted in constructor, so they can be listed in any order. Only operator<
+ * and operator== must be defined and `constexpr`. Calls of this index are not counted by stats.
+ */
+template <typename T, size_t SIZE>
+class StaticSearchIndex {
+   private:
+    std::array<T, SIZE> values;
+
+   public:
+    constexpr StaticSearchIndex(const std::array<T, SIZE>& values) : values(values) {
+        algobox_p::constexprSort(this->values);
+    }
+
+    constexpr size_t size() const { return SIZE; }
+
+    constexpr const T& operator[](size_t index) const { return this->values[index]; }
+
+    constexpr const T* data() const { return this->values.data(); }
+
+    /**
+     * Searches index of the value. The same as `search`.
+     * @returns index of element. If element was not found, -1 is returned.
+     */
+    template <typename U>
+    constexpr int64_t search(const U& value, searchPriority priority = searchPriority::ANY_ENTRANCE) const {
+        // range is represented as [left; right) ( including left and excluding right )
+        int64_t left = 0;
+        int64_t right = int64_t(SIZE);
+
+        if (priority == searchPriority::ANY_ENTRANCE) {
+            while (left < right) {
+                const int64_t currentIndex = (left + right) / 2;
+
+                if (this->values[currentIndex] < value) {
+                    left = currentIndex + 1;
+                } else if (this->values[currentIndex] == value) {
+                    return currentIndex;
+                } else {
+                    right = currentIndex;
+                }
+            }
+
+            return -1;
+        }
+
+        // For LEFT_ENTRANCE find first element which is not less than value,
+        // for RIGHT_ENTRANCE find first element which is bigger than value
+        while (left < right) {
+            const int64_t currentIndex = (left + right) / 2;
+            const T& current = this->values[currentIndex];
+
+            const bool goRight = priority == searchPriority::LEFT_ENTRANCE
+                                     ? current < value
+                                     : current < value || current == value;
+
+            if (goRight) {
+                left = currentIndex + 1;
+            } else {
+                right = currentIndex;
+            }
+        }
+
+        const int64_t index = priority == searchPriority::LEFT_ENTRANCE ? left : left - 1;
+
+        if (index < 0 || index >= int64_t(SIZE) || !(this->values[index] == value))
+            return -1;
+
+        return index;
+    }
+
+    template <typename U>
+    constexpr bool contains(const U& value) const {
+        return this->search(value) != -1;
+    }
+};
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef SEGTREE_HPP
 #define SEGTREE_HPP
 #include <stdint.h>
+#include <array>
+#include "../stats/stats.hpp"
 
 template <typename T,
           void (*_operation_func)(T& result, const T& left, const T& right)>
@@ -67,6 +69,8 @@ class SegmentTree {
      * Has logarithmic complexity
      */
     void setValue(uint32_t index, T value) {
+        ALGOBOX_STATS_CALL(STATS_SEGTREE);
+
         int32_t currentIndex = index + this->size - 1;
 
         this->segments[currentIndex] = value;
@@ -74,6 +78,7 @@ class SegmentTree {
         currentIndex = (currentIndex + 1) / 2 - 1;
 
         for (; currentIndex >= 0; currentIndex = (currentIndex + 1) / 2 - 1) {
+            ALGOBOX_STATS_ADD(STATS_SEGTREE_NODES_UPDATED, 1);
             _operation_func(this->segments[currentIndex],
                             this->segments[currentIndex * 2 + 1],
                             this->segments[currentIndex * 2 + 2]);
@@ -93,6 +98,8 @@ class SegmentTree {
                                                   const T& segment,
                                                   _Args... args),
                          _Args... args) const {
+        ALGOBOX_STATS_CALL(STATS_SEGTREE);
+
         // Segments are organised specific way, where last segments
         // represent individual elements ( i.e. they have length 1 ).
         // In the algorithm we need to start from them
@@ -103,10 +110,12 @@ class SegmentTree {
 
         while (l < r) {
             if (l % 2 == 0) {
+                ALGOBOX_STATS_ADD(STATS_SEGTREE_NODES_VISITED, 1);
                 queryUpdate_func(result, (const T)this->segments[l], args...);
             }
 
             if (r % 2 == 0) {
+                ALGOBOX_STATS_ADD(STATS_SEGTREE_NODES_VISITED, 1);
                 queryUpdate_func(result, (const T)this->segments[r - 1],
                                  args...);
             }
@@ -119,4 +128,111 @@ class SegmentTree {
     };
 };
 
-#endif
\ No newline at end of file
+/**
+ * Segment tree of fixed size, which can be built and queried at compile time. Segments
+ * are stored in std::array, so `constexpr` tree is placed into read-only data and requires
+ * no work at startup. To build it at compile time `_operation_func` and query functions
+ * must be `constexpr`. Calls of this tree are not counted by stats.
+ */
+template <typename T, uint32_t SIZE,
+          void (*_operation_func)(T& result, const T& left, const T& right)>
+class StaticSegmentTree {
+    static_assert(SIZE > 0, "StaticSegmentTree can't be empty");
+
+   private:
+    std::array<T, SIZE * 2 - 1> segments;
+
+   public:
+    constexpr StaticSegmentTree() : segments() {}
+
+    constexpr StaticSegmentTree(const std::array<T, SIZE>& values) : segments() {
+        this->fillup(values.data());
+    }
+
+    /**
+     * Fills Segment Tree with provided values.
+     */
+    constexpr void fillup(const T* array) {
+        for (uint32_t i = 0; i < SIZE; i++) {
+            this->segments[i + SIZE - 1] = array[i];
+        }
+
+        this->updateSegments();
+    }
+
+    /**
+     * Changes value without updating segments.
+     * You need to call `updateSegments` before calling `operate`
+     */
+    constexpr void setValueWithoutUpdate(uint32_t index, T value) {
+        this->segments[index + SIZE - 1] = value;
+    }
+
+    /**
+     * Updates segments, so you can use `operate`.
+     */
+    constexpr void updateSegments() {
+        for (int32_t i = int32_t(SIZE) - 2; i >= 0; i--) {
+            _operation_func(this->segments[i], this->segments[i * 2 + 1],
+                            this->segments[i * 2 + 2]);
+        }
+    }
+
+    constexpr const T& getValue(uint32_t index) const {
+        return this->segments[index + SIZE - 1];
+    }
+
+    constexpr uint32_t size() const { return SIZE; }
+
+    /**
+     * It does what you think it does.
+     * Has logarithmic complexity
+     */
+    constexpr void setValue(uint32_t index, T value) {
+        int32_t currentIndex = index + SIZE - 1;
+
+        this->segments[currentIndex] = value;
+
+        currentIndex = (currentIndex + 1) / 2 - 1;
+
+        for (; currentIndex >= 0; currentIndex = (currentIndex + 1) / 2 - 1) {
+            _operation_func(this->segments[currentIndex],
+                            this->segments[currentIndex * 2 + 1],
+                            this->segments[currentIndex * 2 + 2]);
+        }
+    }
+
+    /**
+     * Gets result for operation at range [l; r) ( including l and excluding r ).
+     * The same as `SegmentTree::operate`.
+     * Has logarithmic complexity
+     */
+    template <typename _QueryResult, typename... _Args>
+    constexpr _QueryResult operate(int32_t l, int32_t r, _QueryResult initialValue,
+                                   void (*queryUpdate_func)(_QueryResult& out,
+                                                            const T& segment,
+                                                            _Args... args),
+                                   _Args... args) const {
+        l += SIZE - 1;
+        r += SIZE - 1;
+
+        _QueryResult result = initialValue;
+
+        while (l < r) {
+            if (l % 2 == 0) {
+                queryUpdate_func(result, this->segments[l], args...);
+            }
+
+            if (r % 2 == 0) {
+                queryUpdate_func(result, this->segments[r - 1], args...);
+            }
+
+            l /= 2;
+            r = (r - 1) / 2;
+        }
+
+        return result;
+    };
+};
+
+#endif
@@ -1,59 +1,437 @@
+#ifndef MINIMUM_HPP
+#define MINIMUM_HPP
 #include <vector>
-#include <queue>
+#include <functional>
+#include <algorithm>
 #include <stdint.h>
+#include "../stats/stats.hpp"
+#include "../utils/parallel.hpp"
 
-template <typename T>
-std::vector<T> minimumForSlidingWindow(const std::vector<T> &array, uint32_t slidingWindowWidth) {
-    if(slidingWindowWidth >= array.size()) {
-        // Sliding window covers whole array, so we have only one minimum.
-        // Do that check for convenient function use.
+// Algobox's private namespace
+namespace algobox_p {
+
+/**
+ * Sliding window extremum over `count` elements starting at `in`. `better(a, b)` returns
+ * true when `a` should be preferred over `b` ( std::less gives minimum, std::greater gives
+ * maximum ). On ties the leftmost element wins.
+ * Calls `sink(windowIndex, bestIndex)` for each of `count - width + 1` windows in order.
+ * `ring` must have space for at least `width` indexes.
+ * Caller must guarantee 1 <= width <= count.
+ */
+template <typename RandomIt, typename Compare, typename Sink>
+void windowExtremumKernel(RandomIt in, uint64_t count, uint64_t width,
+                          uint64_t* ring, const Compare& better, Sink&& sink) {
+    // Ring buffer of indexes works as a deque, but without allocations on each push
+    uint64_t head = 0, tail = 0, used = 0;
 
-        T min = array[0];
+    for(uint64_t i = 0; i < count; i++) {
+        const auto& value = in[i];
 
-        for(const T& value : array) {
-            if(value < min)
-                min = value;
+        // Window moves by one element, so at most one index can leave it
+        if(used != 0 && ring[head] + width <= i) {
+            head = head + 1 == width ? 0 : head + 1;
+            used--;
+            ALGOBOX_STATS_ADD(STATS_SLIDING_WINDOW_POPS, 1);
         }
 
-        std::vector<T> out(1);
+        while(used != 0) {
+            const uint64_t last = tail == 0 ? width - 1 : tail - 1;
+
+            if(!better(value, in[ring[last]]))
+                break;
+
+            tail = last;
+            used--;
+            ALGOBOX_STATS_ADD(STATS_SLIDING_WINDOW_POPS, 1);
+        }
 
-        out[0] = min;
+        ring[tail] = i;
+        tail = tail + 1 == width ? 0 : tail + 1;
+        used++;
+        ALGOBOX_STATS_ADD(STATS_SLIDING_WINDOW_PUSHES, 1);
 
-        return out;
+        if(i + 1 >= width)
+            sink(i + 1 - width, ring[head]);
     }
+}
+
+// Count of adjacent columns processed together by the column pass of 2D window
+const uint64_t COLUMN_BLOCK_SIZE = 32;
+
+/**
+ * The same as `windowExtremumKernel`, but for `columns` adjacent columns of row-major data at
+ * once. Rows are read in order, so every step reads consecutive memory instead of jumping
+ * by `stride`. Every column keeps its own ring of indexes and values, so popped elements are
+ * compared without going back to old rows.
+ * `indexRings` and `valueRings` must have space for `columns * width` elements.
+ * Caller must guarantee 1 <= width <= rows and columns <= COLUMN_BLOCK_SIZE.
+ */
+template <typename T, typename Compare>
+void windowExtremumColumns(const T* in, uint64_t rows, uint64_t stride, uint64_t columns,
+                           uint64_t width, T* out, uint64_t* indexRings, T* valueRings,
+                           const Compare& better) {
+    uint64_t heads[COLUMN_BLOCK_SIZE] = {};
+    uint64_t tails[COLUMN_BLOCK_SIZE] = {};
+    uint64_t used[COLUMN_BLOCK_SIZE] = {};
+
+    for(uint64_t i = 0; i < rows; i++) {
+        const T* row = in + i * stride;
+        T* rowOut = i + 1 >= width ? out + (i + 1 - width) * stride : nullptr;
+
+        for(uint64_t c = 0; c < columns; c++) {
+            uint64_t* indexes = indexRings + c * width;
+            T* values = valueRings + c * width;
+            const T& value = row[c];
+
+            uint64_t head = heads[c], tail = tails[c], count = used[c];
+
+            // Window moves by one element, so at most one index can leave it
+            if(count != 0 && indexes[head] + width <= i) {
+                head = head + 1 == width ? 0 : head + 1;
+                count--;
+                ALGOBOX_STATS_ADD(STATS_SLIDING_WINDOW_POPS, 1);
+            }
+
+            while(count != 0) {
+                const uint64_t last = tail == 0 ? width - 1 : tail - 1;
+
+                if(!better(value, values[last]))
+                    break;
+
+                tail = last;
+                count--;
+                ALGOBOX_STATS_ADD(STATS_SLIDING_WINDOW_POPS, 1);
+            }
+
+            indexes[tail] = i;
+            values[tail] = value;
+            tail = tail + 1 == width ? 0 : tail + 1;
+            count++;
+            ALGOBOX_STATS_ADD(STATS_SLIDING_WINDOW_PUSHES, 1);
+
+            if(rowOut != nullptr)
+                rowOut[c] = values[head];
+
+            heads[c] = head;
+            tails[c] = tail;
+            used[c] = count;
+        }
+    }
+}
+
+template <typename T, typename Compare>
+std::vector<std::vector<T>> extremumForSlidingWindows(const std::vector<T> &array,
+                                                      const std::vector<uint32_t> &widths,
+                                                      const Compare& better) {
+    ALGOBOX_STATS_CALL(STATS_SLIDING_WINDOW);
 
-    std::vector<T> minimums(array.size() - slidingWindowWidth + 1);
+    const uint64_t size = array.size();
 
-    std::deque<T> minimum;
+    std::vector<std::vector<T>> extremums(widths.size());
 
-    // Fill up queue with first window
+    if(size == 0)
+        return extremums;
 
-    for(uint32_t i = 0; i < slidingWindowWidth; i++) {
-        while(!minimum.empty() && minimum.back() > array[i])
-            minimum.pop_back();
+    // Windows bigger than the array are clamped, so they produce only one value
+    // ( the same convention as `minimumForSlidingWindow` has )
+    std::vector<uint64_t> clampedWidths(widths.size());
+    uint64_t maxWidth = 1;
 
-        minimum.push_back(array[i]);
+    for(uint64_t k = 0; k < widths.size(); k++) {
+        clampedWidths[k] = std::min<uint64_t>(widths[k], size);
+        maxWidth = std::max(maxWidth, clampedWidths[k]);
+
+        if(clampedWidths[k] != 0)
+            extremums[k].resize(size - clampedWidths[k] + 1);
     }
 
-    minimums[0] = minimum.front();
+    // One monotonic queue is shared by all widths. As indexes and values in the queue
+    // are both monotonic, extremum for a narrower window is the first queue element
+    // which is still inside that window. So every width only keeps its own head.
+    // Positions are absolute and mapped to ring buffer slots by mask, so ring size is
+    // rounded up to a power of two to avoid division on every access.
+    uint64_t ringSize = 1;
+
+    while(ringSize < maxWidth)
+        ringSize <<= 1;
+
+    const uint64_t mask = ringSize - 1;
 
-    // Current index in minimums array
-    uint32_t currentIdx = 1;
+    std::vector<uint64_t> ring(ringSize);
+    std::vector<uint64_t> heads(widths.size(), 0);
+
+    uint64_t front = 0, back = 0;
+
+    for(uint64_t i = 0; i < size; i++) {
+        if(front != back && ring[front & mask] + maxWidth <= i) {
+            front++;
+            ALGOBOX_STATS_ADD(STATS_SLIDING_WINDOW_POPS, 1);
+        }
 
-    for(uint32_t i = slidingWindowWidth; i < array.size(); i++) {
-        if(minimum.front() == array[i - slidingWindowWidth]) {
-            minimum.pop_front();
+        while(front != back && better(array[i], array[ring[(back - 1) & mask]])) {
+            back--;
+            ALGOBOX_STATS_ADD(STATS_SLIDING_WINDOW_POPS, 1);
         }
 
-        while(!minimum.empty() && minimum.back() > array[i])
-            minimum.pop_back();
+        ring[back & mask] = i;
+        back++;
+        ALGOBOX_STATS_ADD(STATS_SLIDING_WINDOW_PUSHES, 1);
+
+        for(uint64_t k = 0; k < widths.size(); k++) {
+            const uint64_t width = clampedWidths[k];
+
+            if(width == 0)
+                continue;
+
+            uint64_t head = std::max(heads[k], front);
+
+            // Head was popped from the back, so the newest element is the best one
+            if(head >= back)
+                head = back - 1;
+
+            while(ring[head & mask] + width <= i)
+                head++;
 
-        minimum.push_back(array[i]);
+            heads[k] = head;
 
-        minimums[currentIdx] = minimum.front();
-            
-        currentIdx++;
+            if(i + 1 >= width)
+                extremums[k][i + 1 - width] = array[ring[head & mask]];
+        }
     }
 
+    return extremums;
+}
+
+template <typename T, typename Compare>
+void extremumForSlidingWindow2D(const T* data, uint32_t rows, uint32_t cols,
+                                uint32_t windowRows, uint32_t windowCols, T* out,
+                                uint32_t threads, const Compare& better) {
+    ALGOBOX_STATS_CALL(STATS_SLIDING_WINDOW);
+
+    if(rows == 0 || cols == 0 || windowRows == 0 || windowCols == 0)
+        return;
+
+    windowRows = std::min(windowRows, rows);
+    windowCols = std::min(windowCols, cols);
+
+    const uint64_t outCols = cols - windowCols + 1;
+
+    // 2D window extremum is separable: first find extremums in every row, then
+    // find extremums in every column of the intermediate result.
+    std::vector<T> rowExtremums(uint64_t(rows) * outCols);
+
+    parallelFor(rows, cols, threads, [&](uint64_t begin, uint64_t end) {
+        std::vector<uint64_t> ring(windowCols);
+
+        for(uint64_t r = begin; r < end; r++) {
+            T* rowOut = rowExtremums.data() + r * outCols;
+            const T* row = data + r * cols;
+
+            windowExtremumKernel(row, cols, windowCols, ring.data(), better,
+                                 [&](uint64_t window, uint64_t best) { rowOut[window] = row[best]; });
+        }
+    });
+
+    // Columns are processed by blocks of adjacent columns, so the pass reads
+    // intermediate result row by row instead of jumping over it with `outCols` stride
+    const uint64_t columnBlocks = (outCols + COLUMN_BLOCK_SIZE - 1) / COLUMN_BLOCK_SIZE;
+
+    parallelFor(columnBlocks, rows * COLUMN_BLOCK_SIZE, threads, [&](uint64_t begin, uint64_t end) {
+        std::vector<uint64_t> indexRings(COLUMN_BLOCK_SIZE * windowRows);
+        std::vector<T> valueRings(COLUMN_BLOCK_SIZE * windowRows);
+
+        for(uint64_t block = begin; block < end; block++) {
+            const uint64_t firstColumn = block * COLUMN_BLOCK_SIZE;
+            const uint64_t columns = std::min(COLUMN_BLOCK_SIZE, outCols - firstColumn);
+
+            windowExtremumColumns(rowExtremums.data() + firstColumn, rows, outCols, columns,
+                                  windowRows, out + firstColumn, indexRings.data(),
+                                  valueRings.data(), better);
+        }
+    });
+}
+
+};
+
+/**
+ * @brief Returns count of values produced by sliding window functions, so output buffer
+ *        can be allocated beforehand. Window bigger than the array produces one value,
+ *        empty array or zero width produce nothing.
+ */
+inline uint64_t slidingWindowOutputSize(uint64_t size, uint64_t slidingWindowWidth) {
+    if(size == 0 || slidingWindowWidth == 0)
+        return 0;
+
+    return size - std::min(size, slidingWindowWidth) + 1;
+}
+
+/**
+ * @brief Finds extremum in every sliding window. Works with any random access iterators
+ *        ( raw pointers, spans, mmapped columns ), so data doesn't need to be copied.
+ *        Has complexity of O(n) and doesn't allocate memory.
+ * @param begin - iterator to the first element
+ * @param end - iterator to the element above last
+ * @param slidingWindowWidth - window width. Width bigger than the array is clamped, so
+ *                             only one value ( for the whole array ) is produced.
+ * @param out - output iterator to write `slidingWindowOutputSize(end - begin, width)`
+ *              values to
+ * @param better - `bool better(const T& a, const T& b)` - returns true if `a` should be
+ *                 chosen over `b`. std::less gives minimum, std::greater gives maximum.
+ * @param ring - location of allocated data for `min(width, end - begin)` indexes, used as
+ *               the queue. Can be reused between calls.
+ * @return count of written values
+ */
+template <typename RandomIt, typename OutIt, typename Compare>
+uint64_t extremumForSlidingWindow(RandomIt begin, RandomIt end, uint64_t slidingWindowWidth,
+                                  OutIt out, const Compare& better, uint64_t* ring) {
+    ALGOBOX_STATS_CALL(STATS_SLIDING_WINDOW);
+
+    const uint64_t size = uint64_t(end - begin);
+    const uint64_t outSize = slidingWindowOutputSize(size, slidingWindowWidth);
+
+    if(outSize == 0)
+        return 0;
+
+    const uint64_t width = size - outSize + 1;
+
+    algobox_p::windowExtremumKernel(begin, size, width, ring, better,
+                                    [&](uint64_t, uint64_t best) { *out++ = begin[best]; });
+
+    return outSize;
+}
+
+/**
+ * @brief The same as `extremumForSlidingWindow` with `ring`, but allocates the queue itself.
+ *        Uses O(w) memory.
+ */
+template <typename RandomIt, typename OutIt, typename Compare>
+uint64_t extremumForSlidingWindow(RandomIt begin, RandomIt end, uint64_t slidingWindowWidth,
+                                  OutIt out, const Compare& better) {
+    std::vector<uint64_t> ring(std::min(uint64_t(end - begin), slidingWindowWidth));
+
+    return extremumForSlidingWindow(begin, end, slidingWindowWidth, out, better, ring.data());
+}
+
+/**
+ * @brief The same as `extremumForSlidingWindow`, but writes indexes of extremums
+ *        ( relative to `begin` ) instead of values. On ties the leftmost index is written.
+ */
+template <typename RandomIt, typename OutIt, typename Compare>
+uint64_t argExtremumForSlidingWindow(RandomIt begin, RandomIt end, uint64_t slidingWindowWidth,
+                                     OutIt out, const Compare& better, uint64_t* ring) {
+    ALGOBOX_STATS_CALL(STATS_SLIDING_WINDOW);
+
+    const uint64_t size = uint64_t(end - begin);
+    const uint64_t outSize = slidingWindowOutputSize(size, slidingWindowWidth);
+
+    if(outSize == 0)
+        return 0;
+
+    const uint64_t width = size - outSize + 1;
+
+    algobox_p::windowExtremumKernel(begin, size, width, ring, better,
+                                    [&](uint64_t, uint64_t best) { *out++ = best; });
+
+    return outSize;
+}
+
+template <typename RandomIt, typename OutIt, typename Compare>
+uint64_t argExtremumForSlidingWindow(RandomIt begin, RandomIt end, uint64_t slidingWindowWidth,
+                                     OutIt out, const Compare& better) {
+    std::vector<uint64_t> ring(std::min(uint64_t(end - begin), slidingWindowWidth));
+
+    return argExtremumForSlidingWindow(begin, end, slidingWindowWidth, out, better, ring.data());
+}
+
+template <typename RandomIt, typename OutIt>
+uint64_t minimumForSlidingWindow(RandomIt begin, RandomIt end, uint64_t slidingWindowWidth, OutIt out) {
+    return extremumForSlidingWindow(begin, end, slidingWindowWidth, out, std::less<>());
+}
+
+template <typename RandomIt, typename OutIt>
+uint64_t maximumForSlidingWindow(RandomIt begin, RandomIt end, uint64_t slidingWindowWidth, OutIt out) {
+    return extremumForSlidingWindow(begin, end, slidingWindowWidth, out, std::greater<>());
+}
+
+template <typename RandomIt, typename OutIt>
+uint64_t argminimumForSlidingWindow(RandomIt begin, RandomIt end, uint64_t slidingWindowWidth, OutIt out) {
+    return argExtremumForSlidingWindow(begin, end, slidingWindowWidth, out, std::less<>());
+}
+
+template <typename RandomIt, typename OutIt>
+uint64_t argmaximumForSlidingWindow(RandomIt begin, RandomIt end, uint64_t slidingWindowWidth, OutIt out) {
+    return argExtremumForSlidingWindow(begin, end, slidingWindowWidth, out, std::greater<>());
+}
+
+template <typename T>
+std::vector<T> minimumForSlidingWindow(const std::vector<T> &array, uint32_t slidingWindowWidth) {
+    // Sliding window bigger than the array covers whole array, so we have only one minimum.
+    // Do that for convenient function use.
+    std::vector<T> minimums(slidingWindowOutputSize(array.size(), slidingWindowWidth));
+
+    minimumForSlidingWindow(array.data(), array.data() + array.size(), slidingWindowWidth,
+                            minimums.data());
+
     return minimums;
-}
\ No newline at end of file
+}
+
+/**
+ * Finds minimums in sliding windows of several widths with a single pass over the array.
+ * Has complexity of O(nk), where n is size of the array and k - count of widths.
+ * @param array - values
+ * @param widths - widths of sliding windows. Width bigger than array size produces only one
+ *                 minimum ( for the whole array ), zero width produces no values.
+ * @return minimums for every width in the same order as `widths` are.
+ *         For width `w` there are `array.size() - w + 1` minimums.
+ */
+template <typename T>
+std::vector<std::vector<T>> minimumForSlidingWindows(const std::vector<T> &array,
+                                                     const std::vector<uint32_t> &widths) {
+    return algobox_p::extremumForSlidingWindows(array, widths, std::less<T>());
+}
+
+/**
+ * The same as `minimumForSlidingWindows`, but for maximums.
+ */
+template <typename T>
+std::vector<std::vector<T>> maximumForSlidingWindows(const std::vector<T> &array,
+                                                     const std::vector<uint32_t> &widths) {
+    return algobox_p::extremumForSlidingWindows(array, widths, std::greater<T>());
+}
+
+/**
+ * Finds minimums in 2D sliding window over row-major matrix. Window is separable, so
+ * rows and then columns are processed independently in several threads.
+ * Has complexity of O(rows * cols).
+ * @param data - row-major matrix of size `rows` x `cols`
+ * @param rows - count of rows
+ * @param cols - count of columns
+ * @param windowRows - window height. Clamped to `rows`.
+ * @param windowCols - window width. Clamped to `cols`.
+ * @param out - location of allocated data of size
+ *              `(rows - windowRows + 1) x (cols - windowCols + 1)` to place row-major
+ *              result to. Should NOT overlap `data`.
+ * @param threads - count of threads to use. 0 means hardware concurrency, but small inputs
+ *                  are processed in fewer threads ( or in the calling one ).
+ * @return nothing
+ */
+template <typename T>
+void minimumForSlidingWindow2D(const T* data, uint32_t rows, uint32_t cols,
+                               uint32_t windowRows, uint32_t windowCols, T* out,
+                               uint32_t threads = 0) {
+    algobox_p::extremumForSlidingWindow2D(data, rows, cols, windowRows, windowCols, out,
+                                          threads, std::less<T>());
+}
+
+/**
+ * The same as `minimumForSlidingWindow2D`, but for maximums.
+ */
+template <typename T>
+void maximumForSlidingWindow2D(const T* data, uint32_t rows, uint32_t cols,
+                               uint32_t windowRows, uint32_t windowCols, T* out,
+                               uint32_t threads = 0) {
+    algobox_p::extremumForSlidingWindow2D(data, rows, cols, windowRows, windowCols, out,
+                                          threads, std::greater<T>());
+}
+
+#endif
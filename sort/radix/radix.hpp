@@ -3,17 +3,8 @@
 #include <string.h>
 #include <stdint.h>
 #include <functional>
-
-// Algobox's private namespace
-namespace algobox_p {
-
-template <typename T>
-struct element_t {
-    uint8_t* key;
-    uint64_t index;
-};
-
-};
+#include "../../stats/stats.hpp"
+#include "../../utils/parallel.hpp"
 
 template <uint32_t N>
 constexpr inline uint64_t getKeyFrom(const uint8_t *bytes) {
@@ -27,28 +18,25 @@ constexpr inline uint64_t getKeyFrom(const uint8_t *bytes) {
     return key;
 };
 
-/**
- * @brief Sorts complex objects which are convertable to some numeric key. Has complexity of
- *        O(nw), where n is size of the array and w - count of bytes in numeric key.
- * @param begin - pointer to the array's first element
- * @param end - pointer to the element above last
- * @param out - location of allocated data to place sorted array to. Should NOT point to the
- *              same location as `begin` points to.
- * @param keyFunc - `void keyFunc(T& element, void** outkey, uint32_t* keylen)` -
- *                  type to numeric key converter. Accepts element and writes to outkey a
- *                  sequence of bytes so it becomes a n-bit key and to keylen length of that
- *                  sequence in bytes. Note that provided outkey points to a NON-ALLOCATED
- *                  data so you need to allocate it first.
- * @param freeKeys - if true, then all keys returned by keyFunc are freed by delete operator.
- * @return nothing, 
-*/
-template <uint32_t BYTES = 1, typename T, typename U>
-void radixSort(T* begin, T* end, T* out, const U &keyFunc, bool freeKeys = false) {
-    using algobox_p::element_t;
+// Algobox's private namespace
+namespace algobox_p {
 
+template <typename T>
+struct element_t {
+    uint8_t* key;
+    uint64_t index;
+};
+
+/**
+ * Sorts elements by keys returned by `keyFunc`. Returns pointer to the sorted elements,
+ * where `index` is position of the element in the source array. `bufferOrigin` receives
+ * the allocated buffer, which should be freed with `freeElements`.
+ */
+template <uint32_t BYTES, typename T, typename U>
+element_t<T>* radixSortElements(T* begin, uint64_t arraySize, const U &keyFunc,
+                                element_t<T>*& bufferOrigin) {
     const uint64_t RADIX_SORT_STACK_SIZE = 1ull << (BYTES << 3ull);
 
-    uint64_t arraySize = end - begin;
     uint32_t keySize = 0;
 
     // *************************************************
@@ -61,7 +49,7 @@ void radixSort(T* begin, T* end, T* out, const U &keyFunc, bool freeKeys = false
     // Save original pointer to elements buffer to be able to
     // free two buffers after changing elements and elementBuffer
     // pointers.
-    element_t<T>* elementsBufferOrigin = elements;
+    bufferOrigin = elements;
 
     uint32_t currentKeySize;
 
@@ -95,6 +83,16 @@ void radixSort(T* begin, T* end, T* out, const U &keyFunc, bool freeKeys = false
             counts[getKeyFrom<BYTES>(elements[i].key + key)]++;
         }
 
+        ALGOBOX_STATS_ADD(STATS_RADIX_PASSES, 1);
+
+        // All elements have the same digit, so scattering won't change their order
+        if(counts[getKeyFrom<BYTES>(elements[0].key + key)] == arraySize) {
+            ALGOBOX_STATS_ADD(STATS_RADIX_PASSES_SKIPPED, 1);
+            continue;
+        }
+
+        ALGOBOX_STATS_ADD(STATS_RADIX_BYTES_SCATTERED, arraySize * sizeof(element_t<T>));
+
         for(uint64_t i = 1; i < RADIX_SORT_STACK_SIZE; i++) {
             counts[i] += counts[i - 1];
         }
@@ -139,25 +137,53 @@ void radixSort(T* begin, T* end, T* out, const U &keyFunc, bool freeKeys = false
         std::swap(elements, elementBuffer);
     }
 
-    for(uint64_t i = 0; i < arraySize; i++) {
-        // Don't call copying constructor ( can speed up code for structs and classes )
-        memcpy(out + i, begin + elements[i].index, sizeof(T));
-    }
+    return elements;
+}
 
+template <typename T>
+void freeElements(element_t<T>* elements, element_t<T>* bufferOrigin, uint64_t arraySize, bool freeKeys) {
     if(freeKeys) {
         for(uint64_t i = 0; i < arraySize; i++) {
             delete[] elements[i].key;
         }
     }
 
-    // Deleting `elements` instead of `elementsBufferOrigin` can cause a memory leak
-    delete[] elementsBufferOrigin;
+    // Deleting `elements` instead of `bufferOrigin` can cause a memory leak
+    delete[] bufferOrigin;
+}
+
+// Count of permutation indexes processed at once by every column. Block of indexes stays in
+// L1-cache while it's applied to all columns.
+const uint64_t PERMUTATION_BLOCK_SIZE = 2048;
+
+template <uint32_t SIZE, typename I>
+void gatherBlock(const I* permutation, uint64_t begin, uint64_t end, const uint8_t* in, uint8_t* out) {
+    // memcpy with constant size compiles to a single move and doesn't require alignment
+    for(uint64_t i = begin; i < end; i++) {
+        memcpy(out + i * SIZE, in + uint64_t(permutation[i]) * SIZE, SIZE);
+    }
 }
 
+};
+
 /**
- * @brief Sorts complex objects in place which are convertable to some numeric key. Has
- *        complexity of O(nw), where n is size of the array and w - count of bytes in
- *        numeric key.
+ * Column of a struct-of-arrays table for `applyPermutation`.
+ */
+struct permutationColumn_t {
+    const void* in;
+    // Should NOT overlap `in`
+    void* out;
+    uint32_t elementSize;
+};
+
+template <typename T>
+permutationColumn_t makePermutationColumn(const T* in, T* out) {
+    return {(const void*)in, (void*)out, (uint32_t)sizeof(T)};
+}
+
+/**
+ * @brief Sorts complex objects which are convertable to some numeric key. Has complexity of
+ *        O(nw), where n is size of the array and w - count of bytes in numeric key.
  * @param begin - pointer to the array's first element
  * @param end - pointer to the element above last
  * @param out - location of allocated data to place sorted array to. Should NOT point to the
@@ -171,103 +197,52 @@ void radixSort(T* begin, T* end, T* out, const U &keyFunc, bool freeKeys = false
  * @return nothing, 
 */
 template <uint32_t BYTES = 1, typename T, typename U>
-void radixSortInPlace(T* begin, T* end, const U& keyFunc, bool freeKeys = false) {
+void radixSort(T* begin, T* end, T* out, const U &keyFunc, bool freeKeys = false) {
     using algobox_p::element_t;
 
-    const uint64_t RADIX_SORT_STACK_SIZE = 1ull << (BYTES << 3ull);
+    ALGOBOX_STATS_CALL(STATS_RADIX_SORT);
 
-    uint64_t arraySize = end - begin;
-    uint32_t keySize = 0;
+    const uint64_t arraySize = end - begin;
 
-    // *************************************************
-    // *                  PREPARATION                  *
-    // *************************************************
-
-    element_t<T>* elements = new element_t<T>[arraySize * 2];
-    element_t<T>* elementBuffer = elements + arraySize;
-
-    // Save original pointer to elements buffer to be able to
-    // free two buffers after changing elements and elementBuffer
-    // pointers.
-    element_t<T>* elementsBufferOrigin = elements;
-
-    uint32_t currentKeySize;
+    element_t<T>* elementsBufferOrigin;
+    element_t<T>* elements = algobox_p::radixSortElements<BYTES>(begin, arraySize, keyFunc, elementsBufferOrigin);
 
     for(uint64_t i = 0; i < arraySize; i++) {
-        element_t<T> &element = elements[i];
-
-        keyFunc(begin[i], (void**)&element.key, &currentKeySize);
-        keySize = std::max(keySize, currentKeySize);
-
-        element.index = i;
+        // Don't call copying constructor ( can speed up code for structs and classes )
+        memcpy(out + i, begin + elements[i].index, sizeof(T));
     }
 
-    uint64_t counts[RADIX_SORT_STACK_SIZE];
+    ALGOBOX_STATS_ADD(STATS_RADIX_BYTES_SCATTERED, arraySize * sizeof(T));
 
-    // *************************************************
-    // *                    SORTING                    *
-    // *************************************************
-
-    for(uint32_t key = 0; key < keySize; key += BYTES) {
-        memset(counts, 0, RADIX_SORT_STACK_SIZE * sizeof(uint64_t));
-
-        // In this implementation of radix sort values are sorted ( by digits )
-        // with counting digit occurrences, going through counts array and
-        // on i-th step writing back to counts[i] the sum of all `counts` elements
-        // from 0 to i.
-        // This allows to determine last index of each value, so decrementing
-        // that index on each value occurrence we can get sorted values at the
-        // end.
-
-        for(uint64_t i = 0; i < arraySize; i++) {
-            counts[getKeyFrom<BYTES>(elements[i].key + key)]++;
-        }
-
-        for(uint64_t i = 1; i < RADIX_SORT_STACK_SIZE; i++) {
-            counts[i] += counts[i - 1];
-        }
-
-        uint64_t i = arraySize;
-
-        // This piece of code runs 3 times faster with that optimization, as it
-        // makes data more cacheable in cpu L#-cache
-        for(; i > 4; i -= 4) {
-            element_t<T>& element3 = elements[i - 4];
-            element_t<T>& element2 = elements[i - 3];
-            element_t<T>& element1 = elements[i - 2];
-            element_t<T>& element0 = elements[i - 1];
-
-            uint64_t idx3 = getKeyFrom<BYTES>(element3.key + key);
-            uint64_t idx2 = getKeyFrom<BYTES>(element2.key + key);
-            uint64_t idx1 = getKeyFrom<BYTES>(element1.key + key);
-            uint64_t idx0 = getKeyFrom<BYTES>(element0.key + key);
-
-            // Decrement first to get indexes which start from zero
-            counts[idx0]--;
-            elementBuffer[counts[idx0]] = element0;
-
-            counts[idx1]--;
-            elementBuffer[counts[idx1]] = element1;
-
-            counts[idx2]--;
-            elementBuffer[counts[idx2]] = element2;
-
-            counts[idx3]--;
-            elementBuffer[counts[idx3]] = element3;
-        }
+    algobox_p::freeElements(elements, elementsBufferOrigin, arraySize, freeKeys);
+}
 
-        for(; i > 0; i--) {
-            uint64_t idx = getKeyFrom<BYTES>(elements[i - 1].key + key);
+/**
+ * @brief Sorts complex objects in place which are convertable to some numeric key. Has
+ *        complexity of O(nw), where n is size of the array and w - count of bytes in
+ *        numeric key.
+ * @param begin - pointer to the array's first element
+ * @param end - pointer to the element above last
+ * @param out - location of allocated data to place sorted array to. Should NOT point to the
+ *              same location as `begin` points to.
+ * @param keyFunc - `void keyFunc(T& element, void** outkey, uint32_t* keylen)` -
+ *                  type to numeric key converter. Accepts element and writes to outkey a
+ *                  sequence of bytes so it becomes a n-bit key and to keylen length of that
+ *                  sequence in bytes. Note that provided outkey points to a NON-ALLOCATED
+ *                  data so you need to allocate it first.
+ * @param freeKeys - if true, then all keys returned by keyFunc are freed by delete operator.
+ * @return nothing, 
+*/
+template <uint32_t BYTES = 1, typename T, typename U>
+void radixSortInPlace(T* begin, T* end, const U& keyFunc, bool freeKeys = false) {
+    using algobox_p::element_t;
 
-            // Decrement first to get indexes which start from zero
-            counts[idx]--;
+    ALGOBOX_STATS_CALL(STATS_RADIX_SORT);
 
-            elementBuffer[counts[idx]] = elements[i - 1];
-        }
+    const uint64_t arraySize = end - begin;
 
-        // After every swap `elements` remains always sorted by some key
-        std::swap(elements, elementBuffer);
-    }
+    element_t<T>* elementsBufferOrigin;
+    element_t<T>* elements = algobox_p::radixSortElements<BYTES>(begin, arraySize, keyFunc, elementsBufferOrigin);
 
     for(uint64_t i = 0; i < arraySize; i++) {
         if(elements[i].index == (uint64_t)(-1))
@@ -284,6 +259,7 @@ void radixSortInPlace(T* begin, T* end, const U& keyFunc, bool freeKeys = false)
 
         while(newIndex != i) {
             memcpy(begin + currentIndex, begin + newIndex, sizeof(T));
+            ALGOBOX_STATS_ADD(STATS_RADIX_BYTES_SCATTERED, sizeof(T));
 
             // Invalidate pointer
             elements[currentIndex].index = (uint64_t)(-1);
@@ -294,16 +270,102 @@ void radixSortInPlace(T* begin, T* end, const U& keyFunc, bool freeKeys = false)
         
         elements[currentIndex].index = (uint64_t)(-1);
         memcpy(begin + currentIndex, &initial, sizeof(T));
+        ALGOBOX_STATS_ADD(STATS_RADIX_BYTES_SCATTERED, sizeof(T));
     }
 
-    if(freeKeys) {
-        for(uint64_t i = 0; i < arraySize; i++) {
-            delete[] elements[i].key;
-        }
+    algobox_p::freeElements(elements, elementsBufferOrigin, arraySize, freeKeys);
+}
+
+/**
+ * @brief Computes the permutation which sorts the array, without moving any elements. Helpful
+ *        for wide records or struct-of-arrays tables, where the permutation can be applied
+ *        to every column later ( see `applyPermutation` ). Has complexity of O(nw), where
+ *        n is size of the array and w - count of bytes in numeric key. Sort is stable.
+ * @param begin - pointer to the array's first element
+ * @param end - pointer to the element above last
+ * @param out - location of allocated data to place `end - begin` indexes to. `out[i]` is
+ *              index of the element which is i-th in sorted order. Index type should be big
+ *              enough to hold array size ( uint32_t or uint64_t ).
+ * @param keyFunc - the same as in `radixSort`
+ * @param freeKeys - if true, then all keys returned by keyFunc are freed by delete operator.
+ * @return nothing
+*/
+template <uint32_t BYTES = 1, typename T, typename U, typename I>
+void radixArgsort(T* begin, T* end, I* out, const U &keyFunc, bool freeKeys = false) {
+    using algobox_p::element_t;
+
+    ALGOBOX_STATS_CALL(STATS_RADIX_SORT);
+
+    const uint64_t arraySize = end - begin;
+
+    element_t<T>* elementsBufferOrigin;
+    element_t<T>* elements = algobox_p::radixSortElements<BYTES>(begin, arraySize, keyFunc, elementsBufferOrigin);
+
+    for(uint64_t i = 0; i < arraySize; i++) {
+        out[i] = I(elements[i].index);
     }
 
-    // Deleting `elements` instead of `elementsBufferOrigin` can cause a memory leak
-    delete[] elementsBufferOrigin;
+    ALGOBOX_STATS_ADD(STATS_RADIX_BYTES_SCATTERED, arraySize * sizeof(I));
+
+    algobox_p::freeElements(elements, elementsBufferOrigin, arraySize, freeKeys);
+}
+
+/**
+ * @brief Applies permutation to several columns: `column.out[i] = column.in[permutation[i]]`.
+ *        Permutation is processed by blocks, each block is applied to all columns while
+ *        it's in cache. Blocks are distributed between threads.
+ * @param permutation - permutation, e.g. produced by `radixArgsort`
+ * @param size - count of indexes in permutation and elements in every column
+ * @param columns - columns to apply permutation to, see `makePermutationColumn`
+ * @param columnsCount - count of columns
+ * @param threads - count of threads to use. 0 means hardware concurrency, but small inputs
+ *                  are processed in fewer threads ( or in the calling one ).
+ * @return nothing
+*/
+template <typename I>
+void applyPermutation(const I* permutation, uint64_t size, const permutationColumn_t* columns,
+                      uint32_t columnsCount, uint32_t threads = 0) {
+    using algobox_p::PERMUTATION_BLOCK_SIZE;
+
+    const uint64_t blocks = (size + PERMUTATION_BLOCK_SIZE - 1) / PERMUTATION_BLOCK_SIZE;
+
+    algobox_p::parallelFor(blocks, PERMUTATION_BLOCK_SIZE * std::max(1u, columnsCount), threads, [&](uint64_t firstBlock, uint64_t lastBlock) {
+        for(uint64_t block = firstBlock; block < lastBlock; block++) {
+            const uint64_t begin = block * PERMUTATION_BLOCK_SIZE;
+            const uint64_t end = std::min(size, begin + PERMUTATION_BLOCK_SIZE);
+
+            for(uint32_t c = 0; c < columnsCount; c++) {
+                const uint8_t* in = (const uint8_t*)columns[c].in;
+                uint8_t* out = (uint8_t*)columns[c].out;
+
+                switch(columns[c].elementSize) {
+                    case 1: algobox_p::gatherBlock<1>(permutation, begin, end, in, out); break;
+                    case 2: algobox_p::gatherBlock<2>(permutation, begin, end, in, out); break;
+                    case 4: algobox_p::gatherBlock<4>(permutation, begin, end, in, out); break;
+                    case 8: algobox_p::gatherBlock<8>(permutation, begin, end, in, out); break;
+                    case 16: algobox_p::gatherBlock<16>(permutation, begin, end, in, out); break;
+
+                    default: {
+                        const uint64_t elementSize = columns[c].elementSize;
+
+                        for(uint64_t i = begin; i < end; i++) {
+                            memcpy(out + i * elementSize, in + uint64_t(permutation[i]) * elementSize, elementSize);
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief The same as `applyPermutation` for columns, but for a single array.
+*/
+template <typename I, typename T>
+void applyPermutation(const I* permutation, uint64_t size, const T* in, T* out, uint32_t threads = 0) {
+    const permutationColumn_t column = makePermutationColumn(in, out);
+
+    applyPermutation(permutation, size, &column, 1, threads);
 }
 
 #endif
\ No newline at end of file
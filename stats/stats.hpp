@@ -0,0 +1,240 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+#include <stdint.h>
+#ifdef USE_ALGOBOX_STATS
+#include <atomic>
+#endif
+#if defined(USE_ALGOBOX_PERF) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+#endif
+
+// Hot-path instrumentation. Disabled by default and compiles to nothing. To enable it
+// define USE_ALGOBOX_STATS before including any algorithm. To also count cache misses
+// of every call on Linux define USE_ALGOBOX_PERF.
+
+enum statsAlgorithm {
+    STATS_RADIX_SORT,
+    STATS_BINSEARCH,
+    STATS_SEGTREE,
+    STATS_ZFUNC,
+    STATS_SLIDING_WINDOW,
+    STATS_ALGORITHMS_COUNT
+};
+
+enum statsCounter {
+    // Passes over a key byte ( or several bytes, see BYTES in radixSort )
+    STATS_RADIX_PASSES,
+    // Passes where all elements had the same digit, so scattering was skipped
+    STATS_RADIX_PASSES_SKIPPED,
+    // Bytes written while scattering elements and copying records
+    STATS_RADIX_BYTES_SCATTERED,
+    // Comparisons with array elements ( or calls of `func` in paramSearch )
+    STATS_BINSEARCH_PROBES,
+    // Iterations of narrowing loops for LEFT_ENTRANCE and RIGHT_ENTRANCE
+    STATS_BINSEARCH_NARROWING_STEPS,
+    // Segments passed to the query function in `operate`
+    STATS_SEGTREE_NODES_VISITED,
+    // Segments recalculated in `setValue`
+    STATS_SEGTREE_NODES_UPDATED,
+    // Character comparisons in z-function extension loops
+    STATS_ZFUNC_CHARS_COMPARED,
+    STATS_SLIDING_WINDOW_PUSHES,
+    STATS_SLIDING_WINDOW_POPS,
+    STATS_COUNTERS_COUNT
+};
+
+struct algoboxStats_t {
+    uint64_t counters[STATS_COUNTERS_COUNT];
+    uint64_t calls[STATS_ALGORITHMS_COUNT];
+    // Filled only with USE_ALGOBOX_PERF on Linux
+    uint64_t cacheMisses[STATS_ALGORITHMS_COUNT];
+};
+
+inline const char* statsCounterName(statsCounter counter) {
+    static const char* const names[STATS_COUNTERS_COUNT] = {
+        "radix_passes",
+        "radix_passes_skipped",
+        "radix_bytes_scattered",
+        "binsearch_probes",
+        "binsearch_narrowing_steps",
+        "segtree_nodes_visited",
+        "segtree_nodes_updated",
+        "zfunc_chars_compared",
+        "sliding_window_pushes",
+        "sliding_window_pops",
+    };
+
+    return names[counter];
+}
+
+inline const char* statsAlgorithmName(statsAlgorithm algorithm) {
+    static const char* const names[STATS_ALGORITHMS_COUNT] = {
+        "radix_sort",
+        "binsearch",
+        "segtree",
+        "zfunc",
+        "sliding_window",
+    };
+
+    return names[algorithm];
+}
+
+#ifdef USE_ALGOBOX_STATS
+
+/**
+ * Called after every algorithm call with counters of that call only.
+ * Set it with `setAlgoboxStatsHook`, nullptr disables it.
+ */
+typedef void (*algoboxStatsHook_t)(statsAlgorithm algorithm, const algoboxStats_t &call);
+
+// Algobox's private namespace
+namespace algobox_p {
+
+// Counters are per thread, so instrumented code doesn't need atomics
+inline thread_local algoboxStats_t statsCounters = {};
+
+// Cache misses of worker threads started by this thread ( see parallelFor ). They can't
+// be attributed to an algorithm in the worker, so the running call guard takes them.
+inline thread_local uint64_t statsWorkerCacheMisses = 0;
+
+// Hook is shared by all threads and may be replaced while other threads report to it
+inline std::atomic<algoboxStatsHook_t> statsHook = { nullptr };
+
+inline void statsAdd(algoboxStats_t &to, const algoboxStats_t &from) {
+    for(uint32_t i = 0; i < STATS_COUNTERS_COUNT; i++)
+        to.counters[i] += from.counters[i];
+
+    for(uint32_t i = 0; i < STATS_ALGORITHMS_COUNT; i++) {
+        to.calls[i] += from.calls[i];
+        to.cacheMisses[i] += from.cacheMisses[i];
+    }
+}
+
+inline algoboxStats_t statsDiff(const algoboxStats_t &after, const algoboxStats_t &before) {
+    algoboxStats_t diff;
+
+    for(uint32_t i = 0; i < STATS_COUNTERS_COUNT; i++)
+        diff.counters[i] = after.counters[i] - before.counters[i];
+
+    for(uint32_t i = 0; i < STATS_ALGORITHMS_COUNT; i++) {
+        diff.calls[i] = after.calls[i] - before.calls[i];
+        diff.cacheMisses[i] = after.cacheMisses[i] - before.cacheMisses[i];
+    }
+
+    return diff;
+}
+
+#if defined(USE_ALGOBOX_PERF) && defined(__linux__)
+/**
+ * Per-thread hardware cache miss counter. It's opened lazily on first use and counts
+ * user space misses only. If perf events are unavailable ( e.g. restricted by
+ * perf_event_paranoid ), all reads return 0.
+ */
+class perfCacheMisses_t {
+   private:
+    int fd;
+
+   public:
+    perfCacheMisses_t() {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        this->fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~perfCacheMisses_t() {
+        if(this->fd >= 0)
+            close(this->fd);
+    }
+
+    uint64_t read() const {
+        uint64_t value = 0;
+
+        if(this->fd < 0 || ::read(this->fd, &value, sizeof(value)) != sizeof(value))
+            return 0;
+
+        return value;
+    }
+};
+
+inline uint64_t readCacheMisses() {
+    static thread_local perfCacheMisses_t counter;
+
+    return counter.read();
+}
+#else
+inline uint64_t readCacheMisses() {
+    return 0;
+}
+#endif
+
+/**
+ * Placed at the beginning of every instrumented algorithm. Counts the call, attributes
+ * cache misses to the algorithm and reports counters of the call to the hook.
+ */
+class statsCallGuard_t {
+   private:
+    statsAlgorithm algorithm;
+    algoboxStats_t before;
+    uint64_t cacheMissesBefore;
+    uint64_t workerCacheMissesBefore;
+
+   public:
+    statsCallGuard_t(statsAlgorithm algorithm) {
+        this->algorithm = algorithm;
+        this->before = statsCounters;
+        this->cacheMissesBefore = readCacheMisses();
+        this->workerCacheMissesBefore = statsWorkerCacheMisses;
+    }
+
+    ~statsCallGuard_t() {
+        const uint64_t cacheMisses = readCacheMisses() - this->cacheMissesBefore +
+                                     statsWorkerCacheMisses - this->workerCacheMissesBefore;
+
+        statsCounters.calls[this->algorithm]++;
+        statsCounters.cacheMisses[this->algorithm] += cacheMisses;
+
+        const algoboxStatsHook_t hook = statsHook.load(std::memory_order_relaxed);
+
+        if(hook != nullptr)
+            hook(this->algorithm, statsDiff(statsCounters, this->before));
+    }
+};
+
+};
+
+/**
+ * Returns counters accumulated by the current thread.
+ */
+inline const algoboxStats_t& algoboxStats() {
+    return algobox_p::statsCounters;
+}
+
+inline void resetAlgoboxStats() {
+    algobox_p::statsCounters = algoboxStats_t();
+}
+
+inline void setAlgoboxStatsHook(algoboxStatsHook_t hook) {
+    algobox_p::statsHook.store(hook, std::memory_order_relaxed);
+}
+
+#define ALGOBOX_STATS_ADD(counter, value) (algobox_p::statsCounters.counters[counter] += uint64_t(value))
+#define ALGOBOX_STATS_CALL(algorithm) algobox_p::statsCallGuard_t algoboxStatsCallGuard(algorithm)
+
+#else
+
+#define ALGOBOX_STATS_ADD(counter, value) ((void)0)
+#define ALGOBOX_STATS_CALL(algorithm) ((void)0)
+
+#endif
+
+#endif
@@ -3,8 +3,11 @@
 #include <vector>
 #include <string>
 #include <stdint.h>
+#include "../../stats/stats.hpp"
 
 inline std::vector<uint64_t> zfunc(const std::string &str) {
+    ALGOBOX_STATS_CALL(STATS_ZFUNC);
+
     const uint64_t size = str.size();
 
     // Comparing values of c-array is faster than doing the same
@@ -39,6 +42,9 @@ inline std::vector<uint64_t> zfunc(const std::string &str) {
         while(input[i + currentLen] == input[currentLen])
             currentLen++;
 
+        // Extension started from `r - i + 1` if `i` was inside z-block, last comparison failed
+        ALGOBOX_STATS_ADD(STATS_ZFUNC_CHARS_COMPARED, currentLen + 1 - (i < r ? r - i + 1 : 0));
+
         rawZValues[i] = currentLen;
 
         l = i;
@@ -59,6 +65,9 @@ inline std::vector<uint64_t> zfunc(const std::string &str) {
             while(input[i + currentLen] == input[currentLen])
                 currentLen++;
 
+            // Last comparison is the failed one
+            ALGOBOX_STATS_ADD(STATS_ZFUNC_CHARS_COMPARED, currentLen + 1);
+
             l = i;
             r = i + currentLen - 1;
         } else if(i + rawZValues[i - l] <= r) {
@@ -69,6 +78,8 @@ inline std::vector<uint64_t> zfunc(const std::string &str) {
             while(input[i + currentLen] == input[currentLen])
                 currentLen++;
 
+            ALGOBOX_STATS_ADD(STATS_ZFUNC_CHARS_COMPARED, currentLen - (r - i));
+
             l = i;
             r = i + currentLen - 1;
         }
@@ -0,0 +1,92 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <algorithm>
+#include <stdint.h>
+#include "../stats/stats.hpp"
+
+// Algobox's private namespace
+namespace algobox_p {
+
+// Minimal count of elements processed by one thread. Starting a thread costs
+// microseconds, so smaller inputs are processed in the calling thread.
+const uint64_t PARALLEL_MIN_WORK_PER_THREAD = 1ull << 16;
+
+inline uint32_t hardwareThreads() {
+    // hardware_concurrency() reads system files on every call, so cache it
+    static const uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    return threads;
+}
+
+/**
+ * Splits [0; count) into `threads` contiguous ranges and calls `func(begin, end)` for each
+ * range in a separate thread. Explicit `threads` is used as is ( limited only by `count` ).
+ * With `threads == 0` uses hardware concurrency, but no more threads than needed to give
+ * every thread at least PARALLEL_MIN_WORK_PER_THREAD elements.
+ * @param workPerItem - count of elements processed for every item
+ */
+template <typename F>
+void parallelFor(uint64_t count, uint64_t workPerItem, uint32_t threads, const F& func) {
+    if(threads == 0) {
+        const uint64_t maxThreads = std::max<uint64_t>(1, count * workPerItem / PARALLEL_MIN_WORK_PER_THREAD);
+
+        threads = uint32_t(std::min<uint64_t>(hardwareThreads(), maxThreads));
+    }
+
+    if(threads > count)
+        threads = uint32_t(count);
+
+    if(threads <= 1) {
+        func(uint64_t(0), count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    const uint64_t chunk = (count + threads - 1) / threads;
+
+#ifdef USE_ALGOBOX_STATS
+    algoboxStats_t workerStats = {};
+    uint64_t workerCacheMisses = 0;
+    std::mutex workerStatsLock;
+#endif
+
+    for(uint64_t begin = chunk; begin < count; begin += chunk) {
+        const uint64_t end = std::min(count, begin + chunk);
+
+#ifdef USE_ALGOBOX_STATS
+        // Counters are per thread, so worker's counters are moved to the calling thread
+        workers.emplace_back([&func, &workerStats, &workerCacheMisses, &workerStatsLock, begin, end]() {
+            const algoboxStats_t before = algobox_p::statsCounters;
+            const uint64_t cacheMissesBefore = readCacheMisses();
+            func(begin, end);
+            const uint64_t cacheMisses = readCacheMisses() - cacheMissesBefore;
+
+            std::lock_guard<std::mutex> lock(workerStatsLock);
+            statsAdd(workerStats, statsDiff(algobox_p::statsCounters, before));
+            workerCacheMisses += cacheMisses;
+        });
+#else
+        workers.emplace_back([&func, begin, end]() { func(begin, end); });
+#endif
+    }
+
+    // Current thread takes the first range instead of idling
+    func(uint64_t(0), std::min(count, chunk));
+
+    for(std::thread& worker : workers)
+        worker.join();
+
+#ifdef USE_ALGOBOX_STATS
+    statsAdd(algobox_p::statsCounters, workerStats);
+    algobox_p::statsWorkerCacheMisses += workerCacheMisses;
+#endif
+}
+
+};
+
+#endif